@@ -0,0 +1,82 @@
+// Times rip::load / rip::store against the element-by-element loops they
+// replace. The mapped load is lazy, so each load is followed by a full
+// pass over the data to make the comparison fair.
+//
+//   g++ -std=c++17 -O2 -I.. array_load_bench.cpp ../riprt.cpp -o array_load_bench
+//   ./array_load_bench [element count]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "riprt.h"
+
+template <typename F>
+static double timeMs(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const std::string& name, double ms, size_t bytes) {
+    double mbPerSec = (bytes / (1024.0 * 1024.0)) / (ms / 1000.0);
+    std::cout << "  " << name << ": " << ms << " ms (" << mbPerSec << " MB/s)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 16 * 1024 * 1024;
+    size_t bytes = count * sizeof(int);
+    const std::string bulkPath = "array_load_bench_bulk.bin";
+    const std::string loopPath = "array_load_bench_loop.bin";
+
+    std::vector<int> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<int>(i * 2654435761u);
+    }
+
+    std::cout << "store, " << count << " ints:" << std::endl;
+    report("rip::store", timeMs([&]() { rip::store(bulkPath, values); }), bytes);
+    report("element loop", timeMs([&]() {
+        rip::array_header header;
+        std::memcpy(header.magic, "RIPA", 4);
+        header.type = rip::element_tag<int>::value;
+        header.count = count;
+        std::ofstream out(loopPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (size_t i = 0; i < count; ++i) {
+            out.write(reinterpret_cast<const char*>(&values[i]), sizeof(int));
+        }
+    }), bytes);
+
+    long long bulkSum = 0;
+    long long loopSum = 0;
+    std::cout << "load + sum, " << count << " ints:" << std::endl;
+    report("rip::load", timeMs([&]() {
+        rip::array_view<int> a = rip::load<int>(bulkPath);
+        for (int v : a) bulkSum += v;
+    }), bytes);
+    report("element loop", timeMs([&]() {
+        std::ifstream in(loopPath, std::ios::binary);
+        in.seekg(sizeof(rip::array_header));
+        std::vector<int> a;
+        int v;
+        while (in.read(reinterpret_cast<char*>(&v), sizeof(int))) {
+            a.push_back(v);
+        }
+        for (int x : a) loopSum += x;
+    }), bytes);
+
+    std::remove(bulkPath.c_str());
+    std::remove(loopPath.c_str());
+
+    if (bulkSum != loopSum) {
+        std::cerr << "Error: checksum mismatch " << bulkSum << " != " << loopSum << std::endl;
+        return 1;
+    }
+    return 0;
+}
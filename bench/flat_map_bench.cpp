@@ -0,0 +1,87 @@
+// Insert and lookup throughput of rip::flat_map against std::unordered_map.
+// Lookups are an even mix of hits and misses.
+//
+//   g++ -std=c++17 -O2 -I.. flat_map_bench.cpp ../riprt.cpp -o flat_map_bench
+//   ./flat_map_bench [key count]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "riprt.h"
+
+template <typename F>
+static double timeMs(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const std::string& name, double ms, size_t operations) {
+    std::cout << "  " << name << ": " << ms << " ms (" << (operations / (ms * 1000.0)) << " M ops/s)" << std::endl;
+}
+
+template <typename Key, typename Lookup>
+static long long run(const std::vector<Key>& keys, const std::vector<Key>& queries, Lookup toLookup) {
+    long long sum = 0;
+    rip::flat_map<Key, int> flat;
+    std::unordered_map<Key, int> unordered;
+
+    report("rip::flat_map insert", timeMs([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) flat[keys[i]] = static_cast<int>(i);
+    }), keys.size());
+    report("std::unordered_map insert", timeMs([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) unordered[keys[i]] = static_cast<int>(i);
+    }), keys.size());
+
+    report("rip::flat_map lookup", timeMs([&]() {
+        for (const Key& q : queries) {
+            if (const int* found = flat.find(toLookup(q))) sum += *found;
+        }
+    }), queries.size());
+    report("std::unordered_map lookup", timeMs([&]() {
+        for (const Key& q : queries) {
+            auto it = unordered.find(q);
+            if (it != unordered.end()) sum -= it->second;
+        }
+    }), queries.size());
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::mt19937 gen(1);
+
+    std::vector<int> intKeys(count);
+    for (int& key : intKeys) key = static_cast<int>(gen());
+    std::vector<int> intQueries(count * 2);
+    for (size_t i = 0; i < intQueries.size(); ++i) {
+        intQueries[i] = (i % 2) ? intKeys[gen() % count] : static_cast<int>(gen());
+    }
+
+    std::cout << "int keys, " << count << " inserts, " << intQueries.size() << " lookups:" << std::endl;
+    long long intCheck = run(intKeys, intQueries, [](int key) { return key; });
+
+    size_t stringCount = count / 4;
+    std::vector<std::string> stringKeys(stringCount);
+    for (std::string& key : stringKeys) key = "key_" + std::to_string(gen());
+    std::vector<std::string> stringQueries(stringCount * 2);
+    for (size_t i = 0; i < stringQueries.size(); ++i) {
+        stringQueries[i] = (i % 2) ? stringKeys[gen() % stringCount] : "miss_" + std::to_string(gen());
+    }
+
+    std::cout << "string keys (string_view lookup), " << stringCount << " inserts, " << stringQueries.size() << " lookups:" << std::endl;
+    long long stringCheck = run(stringKeys, stringQueries, [](const std::string& key) { return std::string_view(key); });
+
+    // Each hit adds in one loop and subtracts in the other.
+    if (intCheck != 0 || stringCheck != 0) {
+        std::cerr << "Error: lookup results differ between the two maps" << std::endl;
+        return 1;
+    }
+    return 0;
+}
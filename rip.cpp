@@ -52,7 +52,7 @@ void RIP::loadDataTypes(const std::string& archFilename, bool& isError) {
     }
 
     std::string line;
-    enum { NONE, NORMAL, ARRAY } currentBlock = NONE;
+    enum { NONE, NORMAL, ARRAY, MAP } currentBlock = NONE;
 
     while (std::getline(file, line)) {
         std::string trimmedLine = trim(line);
@@ -65,6 +65,10 @@ void RIP::loadDataTypes(const std::string& archFilename, bool& isError) {
             currentBlock = ARRAY;
             continue;
         }
+        else if (trimmedLine == "#map_datatypes {") {
+            currentBlock = MAP;
+            continue;
+        }
         else if (trimmedLine == "}") {
             currentBlock = NONE;
             continue;
@@ -76,10 +80,13 @@ void RIP::loadDataTypes(const std::string& archFilename, bool& isError) {
         else if (currentBlock == ARRAY && !trimmedLine.empty()) {
             arrayDataTypes.insert(trimmedLine);
         }
+        else if (currentBlock == MAP && !trimmedLine.empty()) {
+            mapDataTypes.insert(trimmedLine);
+        }
     }
     file.close();
 
-    if (normalDataTypes.empty() && arrayDataTypes.empty()) {
+    if (normalDataTypes.empty() && arrayDataTypes.empty() && mapDataTypes.empty()) {
         std::cerr << "Warning: No data types loaded from " << archFilename << ". Please check the file format and content." << std::endl;
     }
 }
@@ -93,6 +100,25 @@ bool RIP::isArrayDataType(const std::string& type) {
     return arrayDataTypes.count(type);
 }
 
+bool RIP::isBinaryElementType(const std::string& type) {
+    // Must match the rip::element_tag specializations in riprt.h
+    return type == "int" || type == "float" || type == "char";
+}
+
+bool RIP::needsRuntime(const std::string& line) {
+    // load/store and map[K,V] lower to code from riprt.h / riprt.cpp
+    static const std::regex runtime_regex(R"(^(map\s*\[|store\s*\(|[a-zA-Z_][a-zA-Z0-9_]*\s*\[\]\s*[a-zA-Z_][a-zA-Z0-9_]*\s*=\s*load\s*\())");
+    return std::regex_search(trim(line), runtime_regex);
+}
+
+bool RIP::usesRuntime() const {
+    return runtimeUsed;
+}
+
+bool RIP::isMapDataType(const std::string& type) {
+    return mapDataTypes.count(type);
+}
+
 void RIP::compile(const std::string& filename, bool& isError) {
     isError = false;
 
@@ -126,6 +152,9 @@ void RIP::compile(const std::string& filename, bool& isError) {
         lines.push_back(line);
     }
 
+    arrayVariables.clear();
+    runtimeUsed = std::any_of(lines.begin(), lines.end(), [this](const std::string& l) { return needsRuntime(l); });
+
     bool insideMultilineComment = false;
     for (size_t i = 0; i < lines.size(); i++) {
         std::string currentLine = lines[i];
@@ -196,11 +225,14 @@ std::string RIP::convert(const std::string& line, int lineNumber, bool& isError)
         if (start != std::string::npos && end != std::string::npos) {
             std::string filename = trimmed.substr(start, end - start);
             return (filename.find("stdio") != std::string::npos) ?
-                "#include<iostream>\n#include<vector>\n#include<string>\n" : "#include \"" + filename + "\"";
+                "#include<iostream>\n#include<vector>\n#include<string>\n" + std::string(runtimeUsed ? "#include \"riprt.h\"\n" : "") : "#include \"" + filename + "\"";
         }
     }
     
     if (trimmed.find("def ") == 0) {
+        // Array declarations are only tracked per function for the store() check
+        arrayVariables.clear();
+
         size_t nameStart = trimmed.find(' ') + 1;
         size_t nameEnd = trimmed.find('(', nameStart);
         if (nameEnd != std::string::npos) {
@@ -265,6 +297,32 @@ std::string RIP::convert(const std::string& line, int lineNumber, bool& isError)
         }
     }
 
+    // Map declaration (e.g., "map[string,int] m;")
+    std::regex map_decl_regex(R"(^map\s*\[\s*([a-zA-Z_][a-zA-Z0-9_]*)\s*,\s*([a-zA-Z_][a-zA-Z0-9_]*)\s*\]\s*([a-zA-Z_][a-zA-Z0-9_]*)\s*(.*)$)");
+    std::smatch map_matches;
+    if (std::regex_match(trimmed, map_matches, map_decl_regex)) {
+        std::string keyType = map_matches[1].str();
+        std::string valueType = map_matches[2].str();
+        std::string var_name = map_matches[3].str();
+        std::string remainder = map_matches[4].str();
+
+        if (!isMapDataType(keyType)) {
+            reportError("Invalid map key type '" + keyType + "'. Type not found in map_datatypes.", lineNumber, line);
+            isError = true;
+            return "";
+        }
+        if (!isMapDataType(valueType)) {
+            reportError("Invalid map value type '" + valueType + "'. Type not found in map_datatypes.", lineNumber, line);
+            isError = true;
+            return "";
+        }
+
+        std::string cppKeyType = (keyType == "string" ? "std::string" : keyType);
+        std::string cppValueType = (valueType == "string" ? "std::string" : valueType);
+        convertedLine = line.substr(0, line.find(trimmed)) + "rip::flat_map<" + cppKeyType + ", " + cppValueType + "> " + var_name + remainder;
+        return convertedLine;
+    }
+
     // Range Expression
     std::regex array_decl_with_range_regex(R"(^\s*([a-zA-Z_][a-zA-Z0-9_]*)\s*\[\]\s*([a-zA-Z_][a-zA-Z0-9_]*)\s*=\s*\[(.*?)\]\s*;?\s*$)");
     std::smatch array_matches;
@@ -290,6 +348,7 @@ std::string RIP::convert(const std::string& line, int lineNumber, bool& isError)
             temp_vec_creation += "for(" + cpp_type + " i = start_val; i >= end_val; --i) { v" + id + ".push_back(i); } ";
             temp_vec_creation += "} return v" + id + "; }())";
 
+            arrayVariables[var_name] = type;
             convertedLine = line.substr(0, line.find(trimmed)) + "std::vector<" + cpp_type + "> " + var_name + " = " + temp_vec_creation + ";";
             return convertedLine;
         }
@@ -307,11 +366,27 @@ std::string RIP::convert(const std::string& line, int lineNumber, bool& isError)
             lookupType = "std::string";
         }
 
+        // Binary array load (e.g., "int[] a = load("file.bin");"), mapped read-only
+        std::regex load_regex(R"(^=\s*load\s*\((.*)\)\s*;?\s*$)");
+        std::smatch load_matches;
+        bool isLoad = std::regex_match(remainder, load_matches, load_regex);
+        if (isLoad && !isBinaryElementType(type)) {
+            reportError("Cannot load array of type '" + type + "'. Only int, float and char arrays can be loaded.", lineNumber, line);
+            isError = true;
+            return "";
+        }
+
         if (!isArrayDataType(lookupType)) {
             reportError("Invalid array data type '" + type + "'. Type not found in array_datatypes.", lineNumber, line);
             isError = true;
             return "";
         }
+        arrayVariables[var_name] = type;
+
+        if (isLoad) {
+            convertedLine = line.substr(0, line.find(trimmed)) + "rip::array_view<" + type + "> " + var_name + " = rip::load<" + type + ">(" + trim(load_matches[1].str()) + ");";
+            return convertedLine;
+        }
 
         convertedLine = "std::vector<" + (type == "string" ? "std::string" : type) + "> " + var_name + remainder;
         return convertedLine;
@@ -466,6 +541,27 @@ std::string RIP::convert(const std::string& line, int lineNumber, bool& isError)
         convertedLine = line; 
     }
 
+    else if (trimmed.find("store(") == 0) {
+        size_t contentStart = trimmed.find('(') + 1;
+        size_t contentEnd = trimmed.find_last_of(')');
+        std::vector<std::string> args;
+        if (contentEnd != std::string::npos && contentEnd >= contentStart) {
+            args = splitParameters(trimmed.substr(contentStart, contentEnd - contentStart));
+        }
+        if (args.size() != 2) {
+            reportError("Invalid store call. Expected 'store(\"file\", array);'", lineNumber, line);
+            isError = true;
+            return "";
+        }
+        auto declared = arrayVariables.find(args[1]);
+        if (declared != arrayVariables.end() && !isBinaryElementType(declared->second)) {
+            reportError("Cannot store array of type '" + declared->second + "'. Only int, float and char arrays can be stored.", lineNumber, line);
+            isError = true;
+            return "";
+        }
+        convertedLine = line.substr(0, line.find("store(")) + "rip::" + trimmed;
+    }
+
     else if (trimmed.find("print(") == 0) {
         size_t contentStart = trimmed.find('(') + 1;
         size_t contentEnd = trimmed.find(')', contentStart);
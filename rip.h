@@ -9,10 +9,14 @@
 class RIP {
 public:
     void compile(const std::string& filename, bool& isError);
+    bool usesRuntime() const;
 
 private:
     std::set<std::string> normalDataTypes;
     std::set<std::string> arrayDataTypes;
+    std::set<std::string> mapDataTypes;
+    std::unordered_map<std::string, std::string> arrayVariables;
+    bool runtimeUsed = false;
 
     static std::vector<int> make_range(int start, int end);
     std::unordered_map<std::string, std::vector<std::string>> parseRiparch(const std::string& filename);
@@ -20,6 +24,9 @@ private:
     void loadDataTypes(const std::string& archFilename, bool& isError);
     bool isNormalDataType(const std::string& type);
     bool isArrayDataType(const std::string& type);
+    bool isMapDataType(const std::string& type);
+    bool isBinaryElementType(const std::string& type);
+    bool needsRuntime(const std::string& line);
 
     std::vector<std::string> splitParameters(const std::string& paramsStr);
 
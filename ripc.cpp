@@ -3,9 +3,44 @@
 #include <cstdlib>
 #include <cstdio>
 #include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <climits>
+#include <unistd.h>
+#endif
 
 #include "rip.h"
 
+// Directory holding the running ripc binary, where the RIP runtime
+// (riprt.h and riprt.cpp) ships. argv[0] is only a fallback, as it has
+// no directory component when ripc is launched through PATH.
+static std::string runtimeDirectory(const char* argv0)
+{
+	std::string exePath;
+#ifdef _WIN32
+	char buffer[MAX_PATH];
+	DWORD length = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+	if (length > 0 && length < MAX_PATH) {
+		exePath.assign(buffer, length);
+	}
+#else
+	char buffer[PATH_MAX];
+	ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+	if (length > 0) {
+		exePath.assign(buffer, static_cast<size_t>(length));
+	}
+#endif
+	if (exePath.empty()) {
+		exePath = argv0;
+	}
+
+	size_t slashPosition = exePath.find_last_of("/\\");
+	return (slashPosition != std::string::npos) ? exePath.substr(0, slashPosition) : ".";
+}
+
 int main(int argc, char* argv[])
 {
 	bool isError = false;
@@ -61,7 +96,18 @@ int main(int argc, char* argv[])
 			}
 			else {
 				file.close();
-				std::string compile_command = "g++ " + filename + " -o " + filename.substr(0, filename.find_last_of('.')) + ".exe";
+				std::string runtimeSources;
+				if (rip.usesRuntime()) {
+					std::string runtimeDir = runtimeDirectory(argv[0]);
+					std::ifstream runtimeHeader(runtimeDir + "/riprt.h");
+					std::ifstream runtimeSource(runtimeDir + "/riprt.cpp");
+					if (!runtimeHeader || !runtimeSource) {
+						std::cerr << "Error: RIP runtime not found. " << filename << " uses load, store or map, which need riprt.h and riprt.cpp next to ripc in " << runtimeDir << std::endl;
+						return -1;
+					}
+					runtimeSources = " -I\"" + runtimeDir + "\" \"" + runtimeDir + "/riprt.cpp\"";
+				}
+				std::string compile_command = "g++ -std=c++17" + runtimeSources + " " + filename + " -o " + filename.substr(0, filename.find_last_of('.')) + ".exe";
 				int compile_result = std::system(compile_command.c_str());
 
 				if (compile_result == 0) {
@@ -0,0 +1,81 @@
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "riprt.h"
+
+namespace rip {
+namespace detail {
+
+void* map_file(const std::string& path, size_t& length) {
+    void* base = nullptr;
+    size_t fileSize = 0;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("load: could not open " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("load: could not stat " + path);
+    }
+    fileSize = static_cast<size_t>(size.QuadPart);
+    if (fileSize >= sizeof(array_header)) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("load: could not open " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("load: could not stat " + path);
+    }
+    fileSize = static_cast<size_t>(st.st_size);
+    if (fileSize >= sizeof(array_header)) {
+        void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            base = addr;
+        }
+    }
+    close(fd);
+#endif
+    if (fileSize < sizeof(array_header)) {
+        throw std::runtime_error("load: file too small for an array header: " + path);
+    }
+    if (!base) {
+        throw std::runtime_error("load: could not map " + path);
+    }
+    length = fileSize;
+    return base;
+}
+
+void unmap_file(void* base, size_t length) {
+#ifdef _WIN32
+    (void)length;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, length);
+#endif
+}
+
+} // namespace detail
+} // namespace rip
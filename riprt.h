@@ -0,0 +1,454 @@
+#ifndef RIPRT_H
+#define RIPRT_H
+
+// RIP runtime support, included by programs that use load, store or map.
+// Platform specific code lives in riprt.cpp, which ripc links into those
+// programs, so no OS headers leak into RIP code from here.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rip {
+
+// Binary array files are a fixed 16 byte header followed by the raw
+// little-endian elements:
+//   char     magic[4]  "RIPA"
+//   uint32_t type      element type tag (see element_tag)
+//   uint64_t count     number of elements
+// Only element types with a tag can be loaded or stored; ripc's
+// isBinaryElementType must list the same types.
+template <typename T> struct element_tag { static constexpr bool supported = false; };
+template <> struct element_tag<int>   { static constexpr bool supported = true; static constexpr uint32_t value = 1; };
+template <> struct element_tag<float> { static constexpr bool supported = true; static constexpr uint32_t value = 2; };
+template <> struct element_tag<char>  { static constexpr bool supported = true; static constexpr uint32_t value = 3; };
+
+struct array_header {
+    char magic[4];
+    uint32_t type;
+    uint64_t count;
+};
+static_assert(sizeof(array_header) == 16, "array_header must be 16 bytes");
+
+namespace detail {
+// Maps the whole file read-only and stores its size in length. Throws
+// std::runtime_error if the file cannot be opened, is shorter than an
+// array_header, or cannot be mapped.
+void* map_file(const std::string& path, size_t& length);
+void unmap_file(void* base, size_t length);
+}
+
+inline bool is_little_endian() {
+    const uint32_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Read-only view over an array file mapped into memory. Elements are never
+// copied; the mapping lives as long as the view does.
+template <typename T>
+class array_view {
+public:
+    array_view() = default;
+    array_view(const array_view&) = delete;
+    array_view& operator=(const array_view&) = delete;
+
+    array_view(array_view&& other) noexcept { swap(other); }
+    array_view& operator=(array_view&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            swap(other);
+        }
+        return *this;
+    }
+    ~array_view() { unmap(); }
+
+    const T& operator[](size_t i) const { return elements[i]; }
+    const T* data() const { return elements; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T* begin() const { return elements; }
+    const T* end() const { return elements + count; }
+
+    static array_view map(const std::string& path);
+
+private:
+    const T* elements = nullptr;
+    size_t count = 0;
+    void* base = nullptr;
+    size_t length = 0;
+
+    void swap(array_view& other) noexcept {
+        std::swap(elements, other.elements);
+        std::swap(count, other.count);
+        std::swap(base, other.base);
+        std::swap(length, other.length);
+    }
+
+    void unmap() {
+        if (!base) return;
+        detail::unmap_file(base, length);
+        elements = nullptr;
+        count = 0;
+        base = nullptr;
+        length = 0;
+    }
+};
+
+template <typename T>
+array_view<T> array_view<T>::map(const std::string& path) {
+    static_assert(element_tag<T>::supported, "rip::load: only int, float and char arrays can be loaded");
+    if (!is_little_endian()) {
+        throw std::runtime_error("load: binary arrays are little-endian, host is not: " + path);
+    }
+
+    array_view<T> view;
+    view.base = detail::map_file(path, view.length);
+
+    array_header header;
+    std::memcpy(&header, view.base, sizeof(header));
+    if (std::memcmp(header.magic, "RIPA", 4) != 0) {
+        throw std::runtime_error("load: not a RIP array file: " + path);
+    }
+    if (header.type != element_tag<T>::value) {
+        throw std::runtime_error("load: element type mismatch in " + path);
+    }
+    if (header.count > (view.length - sizeof(array_header)) / sizeof(T)) {
+        throw std::runtime_error("load: truncated array file: " + path);
+    }
+
+    view.count = static_cast<size_t>(header.count);
+    view.elements = reinterpret_cast<const T*>(static_cast<const char*>(view.base) + sizeof(array_header));
+    return view;
+}
+
+template <typename T>
+array_view<T> load(const std::string& path) {
+    return array_view<T>::map(path);
+}
+
+// Writes the header and then the whole element block in one write call.
+// Accepts anything with data() and size(), so both std::vector and
+// array_view can be stored.
+template <typename Array>
+void store(const std::string& path, const Array& array) {
+    using T = typename std::remove_cv<typename std::remove_reference<decltype(array[0])>::type>::type;
+    static_assert(element_tag<T>::supported, "rip::store: only int, float and char arrays can be stored");
+    if (!is_little_endian()) {
+        throw std::runtime_error("store: binary arrays are little-endian, host is not: " + path);
+    }
+
+    array_header header;
+    std::memcpy(header.magic, "RIPA", 4);
+    header.type = element_tag<T>::value;
+    header.count = static_cast<uint64_t>(array.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("store: could not create " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(array.data()), static_cast<std::streamsize>(array.size() * sizeof(T)));
+    if (!out) {
+        throw std::runtime_error("store: write failed for " + path);
+    }
+}
+
+// Hash used by flat_map. The std::string specialization hashes through
+// std::string_view so lookups can take string_view or literals without
+// building a temporary std::string.
+template <typename K>
+struct map_hash {
+    size_t operator()(const K& key) const { return std::hash<K>{}(key); }
+};
+
+template <>
+struct map_hash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+};
+
+namespace detail {
+template <typename T, typename = void>
+struct is_transparent : std::false_type {};
+template <typename T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+}
+
+// Open-addressing hash map with linear probing. Keys, slot occupancy and
+// value indices live in parallel flat arrays; capacity is a power of two
+// and erase uses backward-shift deletion, so there are no tombstones.
+// Values sit in a std::deque that never moves them, so a reference to a
+// value stays valid until that key is erased, even across rehashes. This
+// keeps RIP statements like m["a"] = m["b"] safe when the write grows the
+// table. Iterators are invalidated by any insert or erase.
+// Lookups take any type convertible to K. When Hash is transparent (as
+// map_hash<std::string> is) they also take any type Hash and Eq accept
+// directly, such as std::string_view, without converting it to K first.
+template <typename K, typename V, typename Hash = map_hash<K>, typename Eq = std::equal_to<>>
+class flat_map {
+public:
+    // Iterators yield a std::pair of references into the map storage rather
+    // than a reference to a stored pair. Because of that proxy reference they
+    // are tagged as input iterators: they work with range-for, it->first and
+    // single-pass algorithms such as std::find_if, std::count_if and
+    // std::for_each, but not with algorithms that need a forward iterator.
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using map_type = typename std::conditional<Const, const flat_map, flat_map>::type;
+        using value_ref = typename std::conditional<Const, const V&, V&>::type;
+
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const K&, value_ref>;
+
+        class pointer {
+        public:
+            explicit pointer(reference ref) : ref(ref) {}
+            const reference* operator->() const { return &ref; }
+
+        private:
+            reference ref;
+        };
+
+        basic_iterator() = default;
+        basic_iterator(map_type* map, size_t slot) : map(map), slot(slot) { skip(); }
+
+        // iterator converts to const_iterator
+        template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        basic_iterator(const basic_iterator<OtherConst>& other) : map(other.map), slot(other.slot) {}
+
+        reference operator*() const { return reference(map->keys[slot], map->value(slot)); }
+        pointer operator->() const { return pointer(**this); }
+
+        basic_iterator& operator++() { ++slot; skip(); return *this; }
+        basic_iterator operator++(int) {
+            basic_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const basic_iterator& other) const { return slot == other.slot; }
+        bool operator!=(const basic_iterator& other) const { return slot != other.slot; }
+
+    private:
+        template <bool> friend class basic_iterator;
+
+        map_type* map = nullptr;
+        size_t slot = 0;
+
+        void skip() {
+            while (slot < map->used.size() && !map->used[slot]) ++slot;
+        }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    flat_map() = default;
+
+private:
+    static constexpr bool transparent = detail::is_transparent<Hash>::value;
+
+    // Key type a lookup with Q actually probes with: Q itself for a
+    // transparent Hash, otherwise K.
+    template <typename Q>
+    using lookup_type = typename std::conditional<transparent, Q, K>::type;
+
+    template <typename Q>
+    using enable_lookup = typename std::enable_if<
+        transparent
+            ? std::is_invocable_r<size_t, const Hash&, const Q&>::value &&
+              std::is_invocable_r<bool, const Eq&, const K&, const Q&>::value
+            : std::is_convertible<const Q&, K>::value,
+        int>::type;
+
+    template <typename Q>
+    using enable_insert = typename std::enable_if<
+        std::is_constructible<K, const Q&>::value, enable_lookup<Q>>::type;
+
+public:
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return used.size(); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, used.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, used.size()); }
+
+    void clear() {
+        keys.clear();
+        indices.clear();
+        used.clear();
+        values.clear();
+        freeValues.clear();
+        count = 0;
+    }
+
+    void reserve(size_t n) {
+        size_t wanted = 8;
+        while (wanted - wanted / 4 < n) wanted *= 2;
+        if (wanted > used.size()) rehash(wanted);
+    }
+
+    template <typename Q, enable_lookup<Q> = 0>
+    V* find(const Q& key) {
+        const lookup_type<Q>& lookup = key;
+        size_t slot = locate(lookup);
+        return slot == npos ? nullptr : &value(slot);
+    }
+
+    template <typename Q, enable_lookup<Q> = 0>
+    const V* find(const Q& key) const {
+        const lookup_type<Q>& lookup = key;
+        size_t slot = locate(lookup);
+        return slot == npos ? nullptr : &value(slot);
+    }
+
+    template <typename Q, enable_lookup<Q> = 0>
+    bool contains(const Q& key) const {
+        const lookup_type<Q>& lookup = key;
+        return locate(lookup) != npos;
+    }
+
+    template <typename Q, enable_lookup<Q> = 0>
+    V& at(const Q& key) {
+        const lookup_type<Q>& lookup = key;
+        size_t slot = locate(lookup);
+        if (slot == npos) throw std::out_of_range("flat_map::at: key not found");
+        return value(slot);
+    }
+
+    template <typename Q, enable_lookup<Q> = 0>
+    const V& at(const Q& key) const {
+        const lookup_type<Q>& lookup = key;
+        size_t slot = locate(lookup);
+        if (slot == npos) throw std::out_of_range("flat_map::at: key not found");
+        return value(slot);
+    }
+
+    template <typename Q, enable_insert<Q> = 0>
+    V& operator[](const Q& key) {
+        const lookup_type<Q>& lookup = key;
+        size_t slot = locate(lookup);
+        if (slot != npos) return value(slot);
+
+        if (used.empty() || count + 1 > used.size() - used.size() / 4) {
+            rehash(used.empty() ? 8 : used.size() * 2);
+        }
+        slot = home(lookup);
+        while (used[slot]) slot = (slot + 1) & (used.size() - 1);
+        if (freeValues.empty()) {
+            indices[slot] = values.size();
+            values.emplace_back();
+        }
+        else {
+            indices[slot] = freeValues.back();
+            freeValues.pop_back();
+        }
+        used[slot] = 1;
+        keys[slot] = K(key);
+        ++count;
+        return value(slot);
+    }
+
+    template <typename Q, enable_lookup<Q> = 0>
+    bool erase(const Q& key) {
+        const lookup_type<Q>& lookup = key;
+        size_t hole = locate(lookup);
+        if (hole == npos) return false;
+        value(hole) = V();
+        freeValues.push_back(indices[hole]);
+
+        size_t mask = used.size() - 1;
+        size_t next = (hole + 1) & mask;
+        while (used[next]) {
+            // Pull an entry back into the hole unless its home slot lies
+            // cyclically in (hole, next], where it would become unreachable.
+            size_t want = home(keys[next]);
+            if (((next - want) & mask) >= ((next - hole) & mask)) {
+                keys[hole] = std::move(keys[next]);
+                indices[hole] = indices[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        used[hole] = 0;
+        keys[hole] = K();
+        --count;
+        return true;
+    }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    std::vector<K> keys;
+    std::vector<size_t> indices;
+    std::vector<unsigned char> used;
+    std::deque<V> values;
+    std::vector<size_t> freeValues;
+    size_t count = 0;
+    unsigned shift = 64;
+
+    V& value(size_t slot) { return values[indices[slot]]; }
+    const V& value(size_t slot) const { return values[indices[slot]]; }
+
+    // Fibonacci hashing spreads weak hashes (std::hash<int> is the identity
+    // on common standard libraries) across the top bits.
+    template <typename Q>
+    size_t home(const Q& key) const {
+        uint64_t h = static_cast<uint64_t>(Hash{}(key));
+        return static_cast<size_t>((h * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    template <typename Q>
+    size_t locate(const Q& key) const {
+        if (count == 0) return npos;
+        size_t slot = home(key);
+        while (used[slot]) {
+            if (Eq{}(keys[slot], key)) return slot;
+            slot = (slot + 1) & (used.size() - 1);
+        }
+        return npos;
+    }
+
+    void rehash(size_t newCapacity) {
+        std::vector<K> oldKeys(newCapacity);
+        std::vector<size_t> oldIndices(newCapacity);
+        std::vector<unsigned char> oldUsed(newCapacity, 0);
+        oldKeys.swap(keys);
+        oldIndices.swap(indices);
+        oldUsed.swap(used);
+
+        shift = 64;
+        for (size_t c = newCapacity; c > 1; c >>= 1) --shift;
+
+        size_t mask = newCapacity - 1;
+        for (size_t i = 0; i < oldUsed.size(); ++i) {
+            if (!oldUsed[i]) continue;
+            size_t slot = home(oldKeys[i]);
+            while (used[slot]) slot = (slot + 1) & mask;
+            used[slot] = 1;
+            keys[slot] = std::move(oldKeys[i]);
+            indices[slot] = oldIndices[i];
+        }
+    }
+};
+
+} // namespace rip
+
+#endif // RIPRT_H
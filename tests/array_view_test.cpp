@@ -0,0 +1,129 @@
+// Checks for rip::load / rip::store and rip::array_view.
+//
+//   g++ -std=c++17 -I.. array_view_test.cpp ../riprt.cpp -o array_view_test && ./array_view_test
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "riprt.h"
+
+static void testRoundTrip() {
+    std::vector<int> values = { 1, 2, 3, 4, 5 };
+    rip::store("array_view_test_a.bin", values);
+
+    rip::array_view<int> a = rip::load<int>("array_view_test_a.bin");
+    assert(a.size() == values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        assert(a[i] == values[i]);
+    }
+
+    rip::store("array_view_test_b.bin", a);
+    rip::array_view<int> b = rip::load<int>("array_view_test_b.bin");
+    assert(b.size() == values.size());
+    assert(b[4] == 5);
+}
+
+static void testMovedFromIsEmpty() {
+    std::vector<int> small = { 7, 8 };
+    std::vector<int> large = { 1, 2, 3, 4 };
+    rip::store("array_view_test_a.bin", small);
+    rip::store("array_view_test_b.bin", large);
+
+    rip::array_view<int> a = rip::load<int>("array_view_test_a.bin");
+    rip::array_view<int> b = rip::load<int>("array_view_test_b.bin");
+
+    a = std::move(b);
+    assert(a.size() == 4 && a[3] == 4);
+    assert(b.empty() && b.size() == 0 && b.data() == nullptr);
+    assert(b.begin() == b.end());
+
+    rip::array_view<int> c(std::move(a));
+    assert(c.size() == 4 && c[0] == 1);
+    assert(a.empty() && a.data() == nullptr);
+}
+
+// Returns the message load threw for path, or "" if it did not throw.
+static std::string loadError(const std::string& path) {
+    try {
+        rip::load<int>(path);
+    }
+    catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+static void writeBytes(const std::string& path, const void* bytes, size_t size) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+}
+
+static void testTypeMismatch() {
+    std::vector<float> values = { 1.5f };
+    rip::store("array_view_test_a.bin", values);
+    assert(loadError("array_view_test_a.bin").find("type mismatch") != std::string::npos);
+}
+
+static void testMissingFile() {
+    std::remove("array_view_test_missing.bin");
+    assert(loadError("array_view_test_missing.bin").find("could not open") != std::string::npos);
+}
+
+static void testShortFile() {
+    const char bytes[] = { 'R', 'I', 'P', 'A', 1, 0, 0, 0 };
+    writeBytes("array_view_test_a.bin", bytes, sizeof(bytes));
+    assert(loadError("array_view_test_a.bin").find("too small") != std::string::npos);
+}
+
+static void testBadMagic() {
+    std::vector<int> values = { 1, 2 };
+    rip::store("array_view_test_a.bin", values);
+
+    std::fstream file("array_view_test_a.bin", std::ios::binary | std::ios::in | std::ios::out);
+    file.write("NOPE", 4);
+    file.close();
+    assert(loadError("array_view_test_a.bin").find("not a RIP array file") != std::string::npos);
+}
+
+static void testCountOverrun() {
+    // Header claims three ints but only two follow.
+    rip::array_header header;
+    std::memcpy(header.magic, "RIPA", 4);
+    header.type = rip::element_tag<int>::value;
+    header.count = 3;
+    const int values[] = { 1, 2 };
+
+    std::vector<char> bytes(sizeof(header) + sizeof(values));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), values, sizeof(values));
+    writeBytes("array_view_test_a.bin", bytes.data(), bytes.size());
+    assert(loadError("array_view_test_a.bin").find("truncated") != std::string::npos);
+
+    // A count large enough to overflow count * sizeof(int) is rejected too.
+    header.count = UINT64_MAX / 2;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    writeBytes("array_view_test_a.bin", bytes.data(), bytes.size());
+    assert(loadError("array_view_test_a.bin").find("truncated") != std::string::npos);
+}
+
+int main() {
+    testRoundTrip();
+    testMovedFromIsEmpty();
+    testTypeMismatch();
+    testMissingFile();
+    testShortFile();
+    testBadMagic();
+    testCountOverrun();
+
+    std::remove("array_view_test_a.bin");
+    std::remove("array_view_test_b.bin");
+    std::cout << "array_view_test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Checks for rip::flat_map, including a randomized differential run
+// against std::unordered_map.
+//
+//   g++ -std=c++17 -I.. flat_map_test.cpp ../riprt.cpp -o flat_map_test && ./flat_map_test
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "riprt.h"
+
+static void testDifferential() {
+    std::mt19937 gen(1);
+    rip::flat_map<int, int> map;
+    std::unordered_map<int, int> reference;
+
+    for (int i = 0; i < 2000000; ++i) {
+        int key = static_cast<int>(gen() % 5000);
+        switch (gen() % 3) {
+        case 0:
+            map[key] = i;
+            reference[key] = i;
+            break;
+        case 1:
+            assert(map.erase(key) == (reference.erase(key) == 1));
+            break;
+        default: {
+            int* found = map.find(key);
+            auto it = reference.find(key);
+            assert((found != nullptr) == (it != reference.end()));
+            if (found) assert(*found == it->second);
+            break;
+        }
+        }
+        assert(map.size() == reference.size());
+    }
+
+    size_t visited = 0;
+    for (auto entry : map) {
+        assert(reference.at(entry.first) == entry.second);
+        ++visited;
+    }
+    assert(visited == reference.size());
+}
+
+static void testStringKeys() {
+    rip::flat_map<std::string, int> map;
+    map["one"] = 1;
+    map[std::string("two")] = 2;
+
+    std::string_view view = "one";
+    assert(map.at(view) == 1);
+    assert(map.contains("two"));
+    assert(map.contains(std::string("two")));
+    assert(!map.contains("three"));
+    assert(map.erase("one"));
+    assert(map.find(view) == nullptr);
+    assert(map.size() == 1);
+}
+
+template <typename Map, typename Q, typename = void>
+struct canFind : std::false_type {};
+template <typename Map, typename Q>
+struct canFind<Map, Q, std::void_t<decltype(std::declval<Map&>().find(std::declval<const Q&>()))>> : std::true_type {};
+
+// Lookup keys are accepted only if they convert to K or the hash is
+// transparent and can hash them directly.
+static_assert(canFind<rip::flat_map<std::string, int>, std::string_view>::value, "string_view lookup");
+static_assert(canFind<rip::flat_map<std::string, int>, const char*>::value, "literal lookup");
+static_assert(!canFind<rip::flat_map<std::string, int>, int>::value, "int is not a string key");
+static_assert(canFind<rip::flat_map<float, int>, int>::value, "int converts to a float key");
+static_assert(!canFind<rip::flat_map<int, int>, std::string>::value, "string is not an int key");
+
+static void testConvertedKeys() {
+    rip::flat_map<float, int> map;
+    map[3] = 1;
+    assert(map.contains(3.0f));
+    assert(map.at(3) == 1);
+}
+
+static void testIterators() {
+    rip::flat_map<int, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = i * 2;
+    }
+
+    auto it = std::find_if(map.begin(), map.end(), [](const auto& entry) { return entry.first == 42; });
+    assert(it != map.end());
+    assert(it->first == 42 && it->second == 84);
+    it->second = 1;
+    assert(map.at(42) == 1);
+
+    assert(std::count_if(map.begin(), map.end(), [](const auto& entry) { return entry.first % 2 == 0; }) == 50);
+
+    const rip::flat_map<int, int>& constMap = map;
+    rip::flat_map<int, int>::const_iterator constIt = map.begin();
+    assert(constIt == constMap.begin());
+    size_t visited = 0;
+    for (auto cit = constMap.begin(); cit != constMap.end(); cit++) {
+        ++visited;
+    }
+    assert(visited == map.size());
+
+    using traits = std::iterator_traits<rip::flat_map<int, int>::iterator>;
+    static_assert(std::is_same<traits::iterator_category, std::input_iterator_tag>::value, "proxy iterator");
+    static_assert(std::is_same<traits::difference_type, std::ptrdiff_t>::value, "difference_type");
+}
+
+static void testLookupDoesNotGrow() {
+    rip::flat_map<std::string, int> map;
+    for (int i = 0; i < 6; ++i) {
+        map[std::to_string(i)] = i;
+    }
+    size_t capacity = map.capacity();
+    int* first = &map["0"];
+
+    for (int i = 0; i < 6; ++i) {
+        map[std::to_string(i)] += 1;
+    }
+    assert(map.capacity() == capacity);
+    assert(first == &map["0"] && *first == 1);
+}
+
+static void testAssignAcrossGrowth() {
+    // RIP lowers m["new"] = m["0"] directly; the right-hand side is
+    // evaluated first and the left-hand insert then grows the table.
+    rip::flat_map<std::string, std::string> strings;
+    for (int i = 0; i < 6; ++i) {
+        strings[std::to_string(i)] = "value " + std::to_string(i);
+    }
+    size_t capacity = strings.capacity();
+    strings["new"] = strings["0"];
+    assert(strings.capacity() > capacity);
+    assert(strings.at("new") == "value 0");
+    assert(strings.at("0") == "value 0");
+
+    rip::flat_map<int, int> ints;
+    for (int i = 0; i < 6; ++i) {
+        ints[i] = i * 10;
+    }
+    int& kept = ints[3];
+    capacity = ints.capacity();
+    ints[100] = ints[5];
+    assert(ints.capacity() > capacity);
+    assert(ints.at(100) == 50);
+    assert(&kept == &ints[3] && kept == 30);
+}
+
+int main() {
+    testDifferential();
+    testStringKeys();
+    testConvertedKeys();
+    testIterators();
+    testLookupDoesNotGrow();
+    testAssignAcrossGrowth();
+
+    std::cout << "flat_map_test passed" << std::endl;
+    return 0;
+}